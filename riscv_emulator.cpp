@@ -2,6 +2,26 @@
 #include <cstdint>
 #include <iomanip>
 #include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <cerrno>
+#include <vector>
+#include <ctime>
+#include <cstdio>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <fcntl.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
 using namespace std;
 
 static inline int32_t sign_extend(uint32_t val, int bits){
@@ -49,10 +69,268 @@ public:
         cout << " - RAM:   0x00000  até 0x7FFFF\n";
         cout << " - VRAM:  0x80000  até 0x8FFFF\n";
         cout << " - I/O:   0x9FC00  até 0x9FFFF\n";
+        cout << "   • UART TX:     0x9FC00\n";
+        cout << "   • UART RX:     0x9FC04\n";
+        cout << "   • UART STATUS: 0x9FC08\n";
         cout << "=================================================\n\n";
     }
 };
 
+// Fila circular lock-free para exatamente um produtor e um consumidor
+template <uint32_t CAPACIDADE>
+class FilaSPSC {
+    static_assert((CAPACIDADE & (CAPACIDADE - 1)) == 0, "CAPACIDADE deve ser potência de 2");
+private:
+    uint8_t dados[CAPACIDADE];
+    atomic<uint32_t> cabeca{0};  // escrita apenas pelo produtor
+    atomic<uint32_t> cauda{0};   // escrita apenas pelo consumidor
+
+public:
+    bool inserir(uint8_t byte) {
+        uint32_t h = cabeca.load(memory_order_relaxed);
+        if (h - cauda.load(memory_order_acquire) == CAPACIDADE) return false;
+        dados[h & (CAPACIDADE - 1)] = byte;
+        cabeca.store(h + 1, memory_order_release);
+        return true;
+    }
+
+    bool remover(uint8_t& byte) {
+        uint32_t t = cauda.load(memory_order_relaxed);
+        if (cabeca.load(memory_order_acquire) == t) return false;
+        byte = dados[t & (CAPACIDADE - 1)];
+        cauda.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    uint32_t remover_lote(uint8_t* destino, uint32_t max) {
+        uint32_t t = cauda.load(memory_order_relaxed);
+        uint32_t n = cabeca.load(memory_order_acquire) - t;
+        if (n > max) n = max;
+        for (uint32_t i = 0; i < n; i++)
+            destino[i] = dados[(t + i) & (CAPACIDADE - 1)];
+        cauda.store(t + n, memory_order_release);
+        return n;
+    }
+
+    bool vazia() const {
+        return cabeca.load(memory_order_acquire) == cauda.load(memory_order_acquire);
+    }
+
+    bool cheia() const {
+        return cabeca.load(memory_order_acquire) - cauda.load(memory_order_acquire) == CAPACIDADE;
+    }
+};
+
+// Descritores de entrada da UART (POSIX e Windows/MinGW)
+static const int ENTRADA_PADRAO = 0;  // stdin
+
+static int abrir_entrada_host(const string& caminho) {
+    if (caminho == "-") {
+#ifdef _WIN32
+        _setmode(ENTRADA_PADRAO, _O_BINARY);
+#endif
+        return ENTRADA_PADRAO;
+    }
+#ifdef _WIN32
+    return _open(caminho.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    // O_NONBLOCK evita que abrir um FIFO espere por um escritor
+    return open(caminho.c_str(), O_RDONLY | O_NONBLOCK);
+#endif
+}
+
+static void fechar_entrada_host(int fd) {
+    if (fd < 0 || fd == ENTRADA_PADRAO) return;
+#ifdef _WIN32
+    _close(fd);
+#else
+    close(fd);
+#endif
+}
+
+static bool criar_pipe_host(int fds[2]) {
+#ifdef _WIN32
+    return _pipe(fds, 4096, _O_BINARY) == 0;
+#else
+    return pipe(fds) == 0;
+#endif
+}
+
+// UART mapeada na janela de E/S. TX alimenta uma fila drenada em lotes por
+// uma thread do host; RX é preenchida por outra thread a partir de arquivo/pipe.
+class Uart {
+public:
+    static const uint32_t BASE = 0x9FC00;
+    static const uint32_t FIM = 0x9FFFF;
+    static const uint32_t REG_TX = BASE + 0x0;      // escrita: envia byte
+    static const uint32_t REG_RX = BASE + 0x4;      // leitura: consome byte
+    static const uint32_t REG_STATUS = BASE + 0x8;
+
+    enum Status {
+        RX_DISPONIVEL = 0x1,
+        TX_LIVRE = 0x2,
+        RX_FIM = 0x4
+    };
+
+private:
+    static const uint32_t TAM_TX = 1u << 16;
+    static const uint32_t TAM_RX = 1u << 12;
+
+    static const int ESPERA_RX_MS = 10;
+
+    FilaSPSC<TAM_TX> fila_tx;
+    FILE* saida;
+    thread thread_tx;
+    atomic<bool> parar_tx{false};
+    FilaSPSC<TAM_RX> fila_rx;
+    int fd_entrada;
+    thread thread_rx;
+    atomic<bool> parar_rx{false};
+    atomic<bool> rx_fim{false};
+    bool ativa = false;
+    uint64_t bytes_tx = 0;
+    uint64_t bytes_descartados = 0;
+
+    void laco_tx() {
+        uint8_t lote[4096];
+        bool pendente = false;
+        for (;;) {
+            // Ler o pedido de parada antes de drenar garante que nada se perde
+            bool parando = parar_tx.load(memory_order_acquire);
+            uint32_t n = fila_tx.remover_lote(lote, sizeof(lote));
+            if (n > 0) {
+                fwrite(lote, 1, n, saida);
+                pendente = true;
+                continue;
+            }
+            if (pendente) {
+                fflush(saida);
+                pendente = false;
+            }
+            if (parando) break;
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    }
+
+    // Espera no máximo ESPERA_RX_MS por dados, para que a thread sempre perceba
+    // o pedido de parada. Retorna bytes lidos, 0 sem dados, -1 em EOF/erro.
+#ifdef _WIN32
+    int ler_entrada(uint8_t* lote, int max) {
+        HANDLE h = (HANDLE)_get_osfhandle(fd_entrada);
+        if (h == INVALID_HANDLE_VALUE) return -1;
+        DWORD tipo = GetFileType(h);
+        if (tipo == FILE_TYPE_PIPE) {
+            DWORD disponivel = 0;
+            if (!PeekNamedPipe(h, nullptr, 0, nullptr, &disponivel, nullptr)) return -1;
+            if (disponivel == 0) {
+                Sleep(ESPERA_RX_MS);
+                return 0;
+            }
+            if (disponivel < (DWORD)max) max = (int)disponivel;
+        } else if (tipo == FILE_TYPE_CHAR) {
+            // Console: a leitura ainda espera o fim da linha digitada
+            if (WaitForSingleObject(h, ESPERA_RX_MS) != WAIT_OBJECT_0) return 0;
+        }
+        int n = _read(fd_entrada, lote, (unsigned)max);
+        return (n > 0) ? n : -1;
+    }
+#else
+    int ler_entrada(uint8_t* lote, int max) {
+        pollfd pfd = { fd_entrada, POLLIN, 0 };
+        int pronto = poll(&pfd, 1, ESPERA_RX_MS);
+        if (pronto == 0 || (pronto < 0 && errno == EINTR)) return 0;
+        if (pronto < 0) return -1;
+        ssize_t n = read(fd_entrada, lote, (size_t)max);
+        if (n < 0 && (errno == EINTR || errno == EAGAIN)) return 0;
+        return (n > 0) ? (int)n : -1;
+    }
+#endif
+
+    void laco_rx() {
+        uint8_t lote[4096];
+        while (!parar_rx.load(memory_order_acquire)) {
+            int n = ler_entrada(lote, (int)sizeof(lote));
+            if (n < 0) break;
+            for (int i = 0; i < n; i++) {
+                while (!fila_rx.inserir(lote[i])) {
+                    if (parar_rx.load(memory_order_acquire)) return;
+                    this_thread::sleep_for(chrono::milliseconds(1));
+                }
+            }
+        }
+        rx_fim.store(true, memory_order_release);
+    }
+
+public:
+    // Saída e descritor de entrada pertencem a quem chama; fd negativo desativa RX
+    Uart(FILE* saida_host = stderr, int fd_entrada_host = -1)
+        : saida(saida_host), fd_entrada(fd_entrada_host) {
+        if (fd_entrada < 0) rx_fim = true;
+    }
+
+    ~Uart() { encerrar(); }
+
+    void iniciar() {
+        if (ativa) return;
+        ativa = true;
+        parar_tx = false;
+        thread_tx = thread(&Uart::laco_tx, this);
+        if (fd_entrada >= 0) {
+            parar_rx = false;
+            thread_rx = thread(&Uart::laco_rx, this);
+        }
+    }
+
+    // Drena o TX pendente e encerra as threads do host
+    void encerrar() {
+        if (!ativa) return;
+        ativa = false;
+        parar_tx.store(true, memory_order_release);
+        thread_tx.join();
+        if (thread_rx.joinable()) {
+            parar_rx.store(true, memory_order_release);
+            thread_rx.join();
+        }
+    }
+
+    bool eh_endereco_uart(uint32_t endereco) const {
+        return (endereco >= BASE && endereco <= FIM);
+    }
+
+    uint32_t ler(uint32_t endereco) {
+        switch (endereco & ~0x3u) {
+        case REG_RX: {
+            uint8_t byte = 0;
+            fila_rx.remover(byte);
+            return byte;
+        }
+        case REG_STATUS: {
+            uint32_t status = 0;
+            // rx_fim é lido antes da fila: a thread de RX publica todos os
+            // bytes antes de marcar o fim, então RX_FIM nunca esconde dados
+            bool fim = rx_fim.load(memory_order_acquire);
+            bool rx_vazia = fila_rx.vazia();
+            if (!rx_vazia) status |= RX_DISPONIVEL;
+            if (!fila_tx.cheia()) status |= TX_LIVRE;
+            if (fim && rx_vazia) status |= RX_FIM;
+            return status;
+        }
+        default:
+            return 0;
+        }
+    }
+
+    // Nunca bloqueia: com a fila cheia o byte é descartado (overrun)
+    void escrever(uint32_t endereco, uint32_t valor) {
+        if ((endereco & ~0x3u) != REG_TX) return;
+        if (fila_tx.inserir((uint8_t)(valor & 0xFF))) bytes_tx++;
+        else bytes_descartados++;
+    }
+
+    uint64_t get_bytes_tx() const { return bytes_tx; }
+    uint64_t get_bytes_descartados() const { return bytes_descartados; }
+};
+
 class Barramento {
 private:
     uint32_t barramento_dados;
@@ -60,6 +338,7 @@ private:
     uint8_t barramento_controle;
     
     Memoria* memoria;
+    Uart* uart = nullptr;
     
 public:
     enum Controle {
@@ -82,9 +361,13 @@ public:
     uint32_t ler(uint32_t endereco) {
         barramento_enderecos = endereco;
         
-        barramento_controle = READ;
-        
-        barramento_dados = memoria->ler32(endereco);
+        if (uart && uart->eh_endereco_uart(endereco)) {
+            barramento_controle = READ | IO;
+            barramento_dados = uart->ler(endereco);
+        } else {
+            barramento_controle = READ;
+            barramento_dados = memoria->ler32(endereco);
+        }
         
         uint32_t dado = barramento_dados;
         
@@ -98,9 +381,13 @@ public:
         
         barramento_dados = valor;
         
-        barramento_controle = WRITE;
-        
-        memoria->escrever32(endereco, valor);
+        if (uart && uart->eh_endereco_uart(endereco)) {
+            barramento_controle = WRITE | IO;
+            uart->escrever(endereco, valor);
+        } else {
+            barramento_controle = WRITE;
+            memoria->escrever32(endereco, valor);
+        }
         
         barramento_controle = IDLE;
     }
@@ -122,6 +409,9 @@ public:
         cout << "\n==========================================\n\n";
     }
     
+    // Com a UART conectada, a janela de E/S deixa de ir para a memória
+    void conectar_uart(Uart* u) { uart = u; }
+
     uint32_t get_dados() const { return barramento_dados; }
     uint32_t get_endereco() const { return barramento_enderecos; }
     uint8_t get_controle() const { return barramento_controle; }
@@ -193,6 +483,7 @@ public:
     uint32_t pc = 0;
     Barramento* barramento;
     uint32_t contador_instrucoes = 0;
+    bool verboso = true;  // false: executa sem formatar o log (fuzzing)
 
     CPU(Barramento* bus) : barramento(bus) {
         regs[0] = 0;
@@ -216,55 +507,55 @@ public:
             case 0x0:
                 if (funct7 == 0x00) {
                     regs[rd] = regs[rs1] + regs[rs2];
-                    cout << "ADD x" << rd << " = x" << rs1 << " + x" << rs2 << "\n";
+                    if (verboso) cout << "ADD x" << rd << " = x" << rs1 << " + x" << rs2 << "\n";
                 } else if (funct7 == 0x20) {
                     regs[rd] = regs[rs1] - regs[rs2];
-                    cout << "SUB x" << rd << " = x" << rs1 << " - x" << rs2 << "\n";
+                    if (verboso) cout << "SUB x" << rd << " = x" << rs1 << " - x" << rs2 << "\n";
                 }
                 break;
 
             case 0x1:
                 regs[rd] = (int32_t)((uint32_t)regs[rs1] << (regs[rs2] & 0x1F));
-                cout << "SLL x" << rd << " = x" << rs1 << " << x" << rs2 << "\n";
+                if (verboso) cout << "SLL x" << rd << " = x" << rs1 << " << x" << rs2 << "\n";
                 break;
 
             case 0x5:
                 if (funct7 == 0x00) {
                     regs[rd] = (int32_t)((uint32_t)regs[rs1] >> (regs[rs2] & 0x1F));
-                    cout << "SRL x" << rd << " = x" << rs1 << " >>u x" << rs2 << "\n";
+                    if (verboso) cout << "SRL x" << rd << " = x" << rs1 << " >>u x" << rs2 << "\n";
                 } else if (funct7 == 0x20) {
                     regs[rd] = regs[rs1] >> (regs[rs2] & 0x1F);
-                    cout << "SRA x" << rd << " = x" << rs1 << " >>s x" << rs2 << "\n";
+                    if (verboso) cout << "SRA x" << rd << " = x" << rs1 << " >>s x" << rs2 << "\n";
                 }
                 break;
 
             case 0x6:
                 regs[rd] = regs[rs1] | regs[rs2];
-                cout << "OR x" << rd << " = x" << rs1 << " | x" << rs2 << "\n";
+                if (verboso) cout << "OR x" << rd << " = x" << rs1 << " | x" << rs2 << "\n";
                 break;
 
             case 0x7:
                 regs[rd] = regs[rs1] & regs[rs2];
-                cout << "AND x" << rd << " = x" << rs1 << " & x" << rs2 << "\n";
+                if (verboso) cout << "AND x" << rd << " = x" << rs1 << " & x" << rs2 << "\n";
                 break;
 
             case 0x4:
                 regs[rd] = regs[rs1] ^ regs[rs2];
-                cout << "XOR x" << rd << " = x" << rs1 << " ^ x" << rs2 << "\n";
+                if (verboso) cout << "XOR x" << rd << " = x" << rs1 << " ^ x" << rs2 << "\n";
                 break;
 
             case 0x2:
                 regs[rd] = (regs[rs1] < regs[rs2]) ? 1 : 0;
-                cout << "SLT x" << rd << " = (x" << rs1 << " < x" << rs2 << ")\n";
+                if (verboso) cout << "SLT x" << rd << " = (x" << rs1 << " < x" << rs2 << ")\n";
                 break;
 
             case 0x3:
                 regs[rd] = ((uint32_t)regs[rs1] < (uint32_t)regs[rs2]) ? 1 : 0;
-                cout << "SLTU x" << rd << " = (ux" << rs1 << " < ux" << rs2 << ")\n";
+                if (verboso) cout << "SLTU x" << rd << " = (ux" << rs1 << " < ux" << rs2 << ")\n";
                 break;
 
             default:
-                cout << "R-type funct3 não implementado: " << funct3 << "\n";
+                if (verboso) cout << "R-type funct3 não implementado: " << funct3 << "\n";
             }
         }
         break;
@@ -278,23 +569,23 @@ public:
             switch (funct3) {
             case 0x0:
                 regs[rd] = regs[rs1] + imm;
-                cout << "ADDI x" << rd << " = x" << rs1 << " + " << imm << "\n";
+                if (verboso) cout << "ADDI x" << rd << " = x" << rs1 << " + " << imm << "\n";
                 break;
 
             case 0x6:
                 regs[rd] = regs[rs1] | imm;
-                cout << "ORI x" << rd << " = x" << rs1 << " | " << imm << "\n";
+                if (verboso) cout << "ORI x" << rd << " = x" << rs1 << " | " << imm << "\n";
                 break;
 
             case 0x7:
                 regs[rd] = regs[rs1] & imm;
-                cout << "ANDI x" << rd << " = x" << rs1 << " & " << imm << "\n";
+                if (verboso) cout << "ANDI x" << rd << " = x" << rs1 << " & " << imm << "\n";
                 break;
 
             case 0x1: {
                 uint32_t sh = get_bits(inst,24,20);
                 regs[rd] = (int32_t)((uint32_t)regs[rs1] << sh);
-                cout << "SLLI x" << rd << " = x" << rs1 << " << " << sh << "\n";
+                if (verboso) cout << "SLLI x" << rd << " = x" << rs1 << " << " << sh << "\n";
                 break;
             }
 
@@ -304,16 +595,16 @@ public:
 
                 if (funct7 == 0x00) {
                     regs[rd] = (int32_t)((uint32_t)regs[rs1] >> sh);
-                    cout << "SRLI x" << rd << " = x" << rs1 << " >>u " << sh << "\n";
+                    if (verboso) cout << "SRLI x" << rd << " = x" << rs1 << " >>u " << sh << "\n";
                 } else {
                     regs[rd] = regs[rs1] >> sh;
-                    cout << "SRAI x" << rd << " = x" << rs1 << " >>s " << sh << "\n";
+                    if (verboso) cout << "SRAI x" << rd << " = x" << rs1 << " >>s " << sh << "\n";
                 }
                 break;
             }
 
             default:
-                cout << "I-type funct3 não implementado: " << funct3 << "\n";
+                if (verboso) cout << "I-type funct3 não implementado: " << funct3 << "\n";
             }
         }
         break;
@@ -332,19 +623,19 @@ public:
             bool take = false;
 
             switch (funct3) {
-            case 0x0: take = (regs[rs1] == regs[rs2]); cout << "BEQ\n"; break;
-            case 0x1: take = (regs[rs1] != regs[rs2]); cout << "BNE\n"; break;
-            case 0x4: take = (regs[rs1] < regs[rs2]);  cout << "BLT\n"; break;
-            case 0x5: take = (regs[rs1] >= regs[rs2]); cout << "BGE\n"; break;
-            case 0x6: take = ((uint32_t)regs[rs1] <  (uint32_t)regs[rs2]); cout << "BLTU\n"; break;
-            case 0x7: take = ((uint32_t)regs[rs1] >= (uint32_t)regs[rs2]); cout << "BGEU\n"; break;
+            case 0x0: take = (regs[rs1] == regs[rs2]); if (verboso) cout << "BEQ\n"; break;
+            case 0x1: take = (regs[rs1] != regs[rs2]); if (verboso) cout << "BNE\n"; break;
+            case 0x4: take = (regs[rs1] < regs[rs2]);  if (verboso) cout << "BLT\n"; break;
+            case 0x5: take = (regs[rs1] >= regs[rs2]); if (verboso) cout << "BGE\n"; break;
+            case 0x6: take = ((uint32_t)regs[rs1] <  (uint32_t)regs[rs2]); if (verboso) cout << "BLTU\n"; break;
+            case 0x7: take = ((uint32_t)regs[rs1] >= (uint32_t)regs[rs2]); if (verboso) cout << "BGEU\n"; break;
             default:
-                cout << "Branch funct3 desconhecido.\n";
+                if (verboso) cout << "Branch funct3 desconhecido.\n";
             }
 
             if (take) {
                 pc = (int32_t)pc + soff;
-                cout << "Branch taken -> pc = 0x" << hex << pc << dec << "\n";
+                if (verboso) cout << "Branch taken -> pc = 0x" << hex << pc << dec << "\n";
                 regs[0] = 0;
                 return;
             }
@@ -362,7 +653,7 @@ public:
 
             regs[rd] = pc + 4;
             pc = (uint32_t)((int32_t)pc + soff);
-            cout << "JAL x" << rd << " -> pc = 0x" << hex << pc << dec << "\n";
+            if (verboso) cout << "JAL x" << rd << " -> pc = 0x" << hex << pc << dec << "\n";
             regs[0] = 0;
             return;
         }
@@ -373,7 +664,7 @@ public:
             uint32_t imm20 = get_bits(inst,31,12);
             int32_t val = (int32_t)(imm20 << 12);
             regs[rd] = val;
-            cout << "LUI x" << rd << " = 0x" << hex << (uint32_t)val << dec << "\n";
+            if (verboso) cout << "LUI x" << rd << " = 0x" << hex << (uint32_t)val << dec << "\n";
         }
         break;
 
@@ -382,7 +673,7 @@ public:
             uint32_t imm20 = get_bits(inst,31,12);
             uint32_t val = imm20 << 12;
             regs[rd] = (int32_t)(pc + val);
-            cout << "AUIPC x" << rd << " = pc + 0x" << hex << val << dec << "\n";
+            if (verboso) cout << "AUIPC x" << rd << " = pc + 0x" << hex << val << dec << "\n";
         }
         break;
         
@@ -396,7 +687,7 @@ public:
             
             if (funct3 == 0x2) {
                 regs[rd] = (int32_t)barramento->ler(endereco);
-                cout << "LW x" << rd << " = MEM[x" << rs1 << " + " << imm 
+                if (verboso) cout << "LW x" << rd << " = MEM[x" << rs1 << " + " << imm 
                      << "] = MEM[0x" << hex << endereco << "] = 0x" 
                      << (uint32_t)regs[rd] << dec << "\n";
             }
@@ -415,7 +706,7 @@ public:
             
             if (funct3 == 0x2) {
                 barramento->escrever(endereco, (uint32_t)regs[rs2]);
-                cout << "SW MEM[x" << rs1 << " + " << offset 
+                if (verboso) cout << "SW MEM[x" << rs1 << " + " << offset 
                      << "] = MEM[0x" << hex << endereco << "] = x" << dec << rs2 
                      << " (0x" << hex << (uint32_t)regs[rs2] << dec << ")\n";
             }
@@ -423,7 +714,7 @@ public:
         break;
 
         default:
-            cout << "Opcode não implementado!\n";
+            if (verboso) cout << "Opcode não implementado!\n";
         }
 
         regs[0] = 0;
@@ -431,6 +722,448 @@ public:
     }
 };
 
+// =======================================================
+// MOTOR RÁPIDO (execução silenciosa, acesso direto à memória)
+// =======================================================
+// Mesma semântica de CPU::executar para programas que só acessam a memória,
+// sem log e sem passar pelo barramento. Não modela a janela de E/S: LW/SW em
+// 0x9FC00-0x9FFFF acessam a RAM, enquanto a CPU com UART conectada acessa os
+// registradores da UART; por isso o FuzzerLockstep roda a referência sem UART.
+// O laço principal continua usando CPU::executar; este motor existe só como
+// implementação otimizada verificada em lockstep pelo fuzzer.
+class MotorRapido {
+public:
+    uint32_t regs[32] = {0};
+    uint32_t pc = 0;
+    Memoria* memoria;
+    uint32_t contador_instrucoes = 0;
+
+    MotorRapido(Memoria* mem) : memoria(mem) {}
+
+    void executar(uint32_t inst) {
+        contador_instrucoes++;
+        uint32_t rd     = get_bits(inst,11,7);
+        uint32_t funct3 = get_bits(inst,14,12);
+        uint32_t rs1    = get_bits(inst,19,15);
+        uint32_t rs2    = get_bits(inst,24,20);
+        uint32_t funct7 = get_bits(inst,31,25);
+        uint32_t a = regs[rs1];
+        uint32_t b = regs[rs2];
+        uint32_t proximo_pc = pc + 4;
+
+        switch (inst & 0x7F) {
+        case 0x33:
+            switch (funct3) {
+            case 0x0:
+                if (funct7 == 0x00)      regs[rd] = a + b;
+                else if (funct7 == 0x20) regs[rd] = a - b;
+                break;
+            case 0x1: regs[rd] = a << (b & 0x1F); break;
+            case 0x5:
+                if (funct7 == 0x00)      regs[rd] = a >> (b & 0x1F);
+                else if (funct7 == 0x20) regs[rd] = (uint32_t)((int32_t)a >> (b & 0x1F));
+                break;
+            case 0x6: regs[rd] = a | b; break;
+            case 0x7: regs[rd] = a & b; break;
+            case 0x4: regs[rd] = a ^ b; break;
+            case 0x2: regs[rd] = ((int32_t)a < (int32_t)b) ? 1 : 0; break;
+            case 0x3: regs[rd] = (a < b) ? 1 : 0; break;
+            }
+            break;
+
+        case 0x13: {
+            uint32_t imm = (uint32_t)sign_extend(get_bits(inst,31,20), 12);
+            switch (funct3) {
+            case 0x0: regs[rd] = a + imm; break;
+            case 0x6: regs[rd] = a | imm; break;
+            case 0x7: regs[rd] = a & imm; break;
+            case 0x1: regs[rd] = a << rs2; break;
+            case 0x5:
+                if (funct7 == 0x00) regs[rd] = a >> rs2;
+                else                regs[rd] = (uint32_t)((int32_t)a >> rs2);
+                break;
+            }
+            break;
+        }
+
+        case 0x63: {
+            uint32_t imm = (get_bits(inst,31,31) << 12)
+                         | (get_bits(inst,7,7) << 11)
+                         | (get_bits(inst,30,25) << 5)
+                         | (get_bits(inst,11,8) << 1);
+            bool take = false;
+            switch (funct3) {
+            case 0x0: take = (a == b); break;
+            case 0x1: take = (a != b); break;
+            case 0x4: take = ((int32_t)a <  (int32_t)b); break;
+            case 0x5: take = ((int32_t)a >= (int32_t)b); break;
+            case 0x6: take = (a <  b); break;
+            case 0x7: take = (a >= b); break;
+            }
+            if (take)
+                proximo_pc = pc + (uint32_t)sign_extend(imm, 13);
+            break;
+        }
+
+        case 0x6F: {
+            uint32_t imm = (get_bits(inst,31,31) << 20)
+                         | (get_bits(inst,19,12) << 12)
+                         | (get_bits(inst,20,20) << 11)
+                         | (get_bits(inst,30,21) << 1);
+            regs[rd] = pc + 4;
+            proximo_pc = pc + (uint32_t)sign_extend(imm, 21);
+            break;
+        }
+
+        case 0x37: regs[rd] = inst & 0xFFFFF000u; break;
+        case 0x17: regs[rd] = pc + (inst & 0xFFFFF000u); break;
+
+        case 0x03:
+            if (funct3 == 0x2)
+                regs[rd] = memoria->ler32(a + (uint32_t)sign_extend(get_bits(inst,31,20), 12));
+            break;
+
+        case 0x23:
+            if (funct3 == 0x2) {
+                uint32_t imm = (funct7 << 5) | rd;
+                memoria->escrever32(a + (uint32_t)sign_extend(imm, 12), b);
+            }
+            break;
+        }
+
+        regs[0] = 0;
+        pc = proximo_pc;
+    }
+};
+
+// =======================================================
+// FUZZING EM LOCKSTEP (MotorRapido x CPU::executar)
+// =======================================================
+// Silencia as mensagens de inicialização enquanto estiver no escopo
+struct SilenciarCout {
+    SilenciarCout()  { cout.setstate(ios::badbit); }
+    ~SilenciarCout() { cout.clear(); }
+};
+
+struct GeradorAleatorio {
+    uint64_t estado;
+
+    GeradorAleatorio(uint64_t semente) : estado(semente ? semente : 0x9E3779B97F4A7C15ull) {}
+
+    uint32_t proximo() {
+        estado ^= estado << 13;
+        estado ^= estado >> 7;
+        estado ^= estado << 17;
+        return (uint32_t)(estado >> 32);
+    }
+
+    uint32_t ate(uint32_t n) { return proximo() % n; }
+};
+
+struct CasoFuzz {
+    uint32_t regs_iniciais[32];
+    vector<uint32_t> programa;
+};
+
+static uint32_t codificar_r(uint32_t f7, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t rd) {
+    return (f7 << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | 0x33;
+}
+
+static uint32_t codificar_i(uint32_t imm, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t opcode) {
+    return ((imm & 0xFFF) << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | opcode;
+}
+
+static uint32_t codificar_s(uint32_t imm, uint32_t rs2, uint32_t rs1) {
+    return (get_bits(imm,11,5) << 25) | (rs2 << 20) | (rs1 << 15) | (0x2 << 12)
+         | (get_bits(imm,4,0) << 7) | 0x23;
+}
+
+static uint32_t codificar_b(int32_t off, uint32_t rs2, uint32_t rs1, uint32_t f3) {
+    uint32_t imm = (uint32_t)off;
+    return (get_bits(imm,12,12) << 31) | (get_bits(imm,10,5) << 25) | (rs2 << 20)
+         | (rs1 << 15) | (f3 << 12) | (get_bits(imm,4,1) << 8) | (get_bits(imm,11,11) << 7) | 0x63;
+}
+
+static uint32_t codificar_j(int32_t off, uint32_t rd) {
+    uint32_t imm = (uint32_t)off;
+    return (get_bits(imm,20,20) << 31) | (get_bits(imm,10,1) << 21) | (get_bits(imm,11,11) << 20)
+         | (get_bits(imm,19,12) << 12) | (rd << 7) | 0x6F;
+}
+
+class FuzzerLockstep {
+private:
+    Memoria* mem_ref;
+    Memoria* mem_rapida;
+    Barramento* bus_ref;
+    CPU* cpu_ref;
+    MotorRapido* motor;
+    vector<uint32_t> escritas_ref;
+    vector<uint32_t> escritas_rapida;
+
+    // Rastreamento de escritas do fuzzer: a Memoria do emulador não sabe nada disso
+    static const uint32_t TAMANHO_PAGINA = 0x1000;
+    static const uint32_t PALAVRAS_POR_PAGINA = TAMANHO_PAGINA / 4;
+    static const uint32_t NUM_PAGINAS = Memoria::TAMANHO_TOTAL / TAMANHO_PAGINA;
+    bool pagina_suja[NUM_PAGINAS];
+    bool reset_completo = true;
+
+    // Registradores concentrados em x0-x7 para gerar dependências de dados
+    static uint32_t sortear_reg(GeradorAleatorio& g) {
+        return (g.ate(4) != 0) ? g.ate(8) : g.ate(32);
+    }
+
+    static uint32_t gerar_instrucao(GeradorAleatorio& g, uint32_t i, uint32_t n) {
+        uint32_t rd  = sortear_reg(g);
+        uint32_t rs1 = sortear_reg(g);
+        uint32_t rs2 = sortear_reg(g);
+        // Desvios sempre apontam para dentro do programa
+        int32_t alvo = ((int32_t)g.ate(n) - (int32_t)i) * 4;
+
+        switch (g.ate(10)) {
+        case 0: case 1: {
+            static const uint32_t ops[10][2] = {
+                {0x0,0x00},{0x0,0x20},{0x1,0x00},{0x5,0x00},{0x5,0x20},
+                {0x6,0x00},{0x7,0x00},{0x4,0x00},{0x2,0x00},{0x3,0x00}
+            };
+            uint32_t k = g.ate(10);
+            return codificar_r(ops[k][1], rs2, rs1, ops[k][0], rd);
+        }
+        case 2: case 3: {
+            static const uint32_t f3s[3] = {0x0, 0x6, 0x7};
+            return codificar_i(g.proximo(), rs1, f3s[g.ate(3)], rd, 0x13);
+        }
+        case 4: {
+            static const uint32_t shifts[3][2] = {{0x1,0x00},{0x5,0x00},{0x5,0x20}};
+            uint32_t k = g.ate(3);
+            return codificar_i((shifts[k][1] << 5) | g.ate(32), rs1, shifts[k][0], rd, 0x13);
+        }
+        case 5: {
+            static const uint32_t f3s[6] = {0x0, 0x1, 0x4, 0x5, 0x6, 0x7};
+            return codificar_b(alvo, rs2, rs1, f3s[g.ate(6)]);
+        }
+        case 6:
+            return codificar_j(alvo, rd);
+        case 7:
+            return (g.proximo() & 0xFFFFF000u) | (rd << 7) | (g.ate(2) ? 0x37 : 0x17);
+        case 8:
+            return codificar_i(g.proximo(), rs1, 0x2, rd, 0x03);
+        default:
+            return codificar_s(g.proximo(), rs2, rs1);
+        }
+    }
+
+    // Registra a palavra que um SW vai escrever, calculada a partir dos
+    // registradores do próprio motor antes de executar a instrução
+    void registrar_store(uint32_t inst, const uint32_t* regs, vector<uint32_t>& escritas) {
+        if ((inst & 0x7F) != 0x23 || get_bits(inst,14,12) != 0x2) return;
+        uint32_t imm = (get_bits(inst,31,25) << 5) | get_bits(inst,11,7);
+        uint32_t idx = (regs[get_bits(inst,19,15)] + (uint32_t)sign_extend(imm, 12)) / 4;
+        if (idx >= Memoria::TAMANHO_TOTAL / 4) return;
+        escritas.push_back(idx);
+        pagina_suja[idx / PALAVRAS_POR_PAGINA] = true;
+    }
+
+    // Zera só as páginas escritas desde o último caso. Depois de uma
+    // divergência um motor pode ter escrito fora do registrado: zera tudo.
+    void resetar_memorias() {
+        for (uint32_t p = 0; p < NUM_PAGINAS; p++) {
+            if (reset_completo || pagina_suja[p]) {
+                memset(&mem_ref->memoria_dados[p * PALAVRAS_POR_PAGINA], 0, TAMANHO_PAGINA);
+                memset(&mem_rapida->memoria_dados[p * PALAVRAS_POR_PAGINA], 0, TAMANHO_PAGINA);
+                pagina_suja[p] = false;
+            }
+        }
+        reset_completo = false;
+    }
+
+    // Compara só as palavras escritas por algum dos motores desde o último
+    // bloco; o registro é mantido em caso de divergência para o relatório
+    bool memorias_iguais() {
+        for (uint32_t idx : escritas_ref)
+            if (mem_ref->memoria_dados[idx] != mem_rapida->memoria_dados[idx]) return false;
+        for (uint32_t idx : escritas_rapida)
+            if (mem_ref->memoria_dados[idx] != mem_rapida->memoria_dados[idx]) return false;
+        escritas_ref.clear();
+        escritas_rapida.clear();
+        return true;
+    }
+
+    bool estados_iguais() {
+        if (cpu_ref->pc != motor->pc) return false;
+        for (int r = 0; r < 32; r++)
+            if ((uint32_t)cpu_ref->regs[r] != motor->regs[r]) return false;
+        return true;
+    }
+
+public:
+    static const uint32_t PASSOS_POR_BLOCO = 8;
+    static const uint32_t MAX_PASSOS = 64;
+    static const uint32_t MAX_PROGRAMA = 32;
+
+    FuzzerLockstep() {
+        SilenciarCout silencio;
+        mem_ref = new Memoria();
+        mem_rapida = new Memoria();
+        bus_ref = new Barramento(mem_ref);
+        cpu_ref = new CPU(bus_ref);
+        motor = new MotorRapido(mem_rapida);
+        cpu_ref->verboso = false;
+    }
+
+    ~FuzzerLockstep() {
+        delete motor;
+        delete cpu_ref;
+        delete bus_ref;
+        delete mem_rapida;
+        delete mem_ref;
+    }
+
+    // Reseta as memórias e confirma que nenhuma escrita ficou para trás
+    bool memorias_zeradas() {
+        resetar_memorias();
+        for (uint32_t i = 0; i < Memoria::TAMANHO_TOTAL / 4; i++)
+            if (mem_ref->memoria_dados[i] != 0 || mem_rapida->memoria_dados[i] != 0) return false;
+        return true;
+    }
+
+    CasoFuzz gerar_caso(GeradorAleatorio& g) {
+        CasoFuzz caso;
+        uint32_t n = 4 + g.ate(MAX_PROGRAMA - 3);
+        caso.regs_iniciais[0] = 0;
+        // Metade dos registradores recebe endereços válidos para exercitar LW/SW
+        for (int r = 1; r < 32; r++)
+            caso.regs_iniciais[r] = g.ate(2) ? g.ate(Memoria::TAMANHO_TOTAL) : g.proximo();
+        caso.programa.resize(n);
+        for (uint32_t i = 0; i < n; i++)
+            caso.programa[i] = gerar_instrucao(g, i, n);
+        return caso;
+    }
+
+    // Retorna o passo (fim de bloco) onde houve divergência, ou -1
+    int executar_caso(const CasoFuzz& caso) {
+        resetar_memorias();
+        for (size_t i = 0; i < caso.programa.size(); i++) {
+            mem_ref->escrever32((uint32_t)i * 4, caso.programa[i]);
+            mem_rapida->escrever32((uint32_t)i * 4, caso.programa[i]);
+            pagina_suja[i / PALAVRAS_POR_PAGINA] = true;
+        }
+        for (int r = 0; r < 32; r++) {
+            cpu_ref->regs[r] = (int32_t)caso.regs_iniciais[r];
+            motor->regs[r] = caso.regs_iniciais[r];
+        }
+        cpu_ref->pc = 0;
+        motor->pc = 0;
+        escritas_ref.clear();
+        escritas_rapida.clear();
+
+        for (uint32_t passo = 0; passo < MAX_PASSOS; ) {
+            for (uint32_t k = 0; k < PASSOS_POR_BLOCO; k++, passo++) {
+                uint32_t inst_ref = bus_ref->ler(cpu_ref->pc);
+                registrar_store(inst_ref, (const uint32_t*)cpu_ref->regs, escritas_ref);
+                cpu_ref->executar(inst_ref);
+
+                uint32_t inst_rapida = mem_rapida->ler32(motor->pc);
+                registrar_store(inst_rapida, motor->regs, escritas_rapida);
+                motor->executar(inst_rapida);
+            }
+            if (!estados_iguais() || !memorias_iguais()) {
+                reset_completo = true;
+                return (int)passo;
+            }
+        }
+        return -1;
+    }
+
+    // Reduz um caso divergente: trunca o programa, troca instruções por NOP
+    // e zera registradores iniciais enquanto a divergência persistir
+    CasoFuzz minimizar(CasoFuzz caso) {
+        const uint32_t NOP = 0x00000013;
+        bool progresso = true;
+        while (progresso) {
+            progresso = false;
+            while (caso.programa.size() > 1) {
+                CasoFuzz tentativa = caso;
+                tentativa.programa.pop_back();
+                if (executar_caso(tentativa) < 0) break;
+                caso = tentativa;
+                progresso = true;
+            }
+            for (size_t i = 0; i < caso.programa.size(); i++) {
+                if (caso.programa[i] == NOP) continue;
+                CasoFuzz tentativa = caso;
+                tentativa.programa[i] = NOP;
+                if (executar_caso(tentativa) >= 0) { caso = tentativa; progresso = true; }
+            }
+            for (int r = 1; r < 32; r++) {
+                if (caso.regs_iniciais[r] == 0) continue;
+                CasoFuzz tentativa = caso;
+                tentativa.regs_iniciais[r] = 0;
+                if (executar_caso(tentativa) >= 0) { caso = tentativa; progresso = true; }
+            }
+        }
+        return caso;
+    }
+
+    void imprimir_caso(const CasoFuzz& caso) {
+        cout << "Registradores iniciais (não-zero):\n";
+        for (int r = 1; r < 32; r++) {
+            if (caso.regs_iniciais[r] != 0)
+                cout << "  x" << dec << r << " = 0x" << hex << setw(8) << setfill('0')
+                     << caso.regs_iniciais[r] << dec << "\n";
+        }
+        cout << "Programa:\n";
+        for (size_t i = 0; i < caso.programa.size(); i++)
+            cout << "  0x" << hex << setw(5) << setfill('0') << (i * 4) << ": 0x"
+                 << setw(8) << caso.programa[i] << dec << "\n";
+
+        int passo = executar_caso(caso);
+        cout << "Divergência ao fim do passo " << passo << ":\n";
+        cout << "  PC ref = 0x" << hex << cpu_ref->pc << "  PC rápido = 0x" << motor->pc << dec << "\n";
+        for (int r = 0; r < 32; r++) {
+            if ((uint32_t)cpu_ref->regs[r] != motor->regs[r])
+                cout << "  x" << r << ": ref = 0x" << hex << (uint32_t)cpu_ref->regs[r]
+                     << "  rápido = 0x" << motor->regs[r] << dec << "\n";
+        }
+        if (!memorias_iguais())
+            cout << "  Memória divergente\n";
+    }
+
+    // Roda 'casos' casos a partir de 'semente'; retorna o número de divergências
+    uint64_t rodar(uint64_t casos, uint64_t semente, uint64_t max_relatos = 1) {
+        GeradorAleatorio g(semente);
+        uint64_t divergencias = 0;
+        for (uint64_t c = 0; c < casos; c++) {
+            CasoFuzz caso = gerar_caso(g);
+            if (executar_caso(caso) < 0) continue;
+            divergencias++;
+            if (divergencias <= max_relatos) {
+                cout << "\n[FUZZ] Divergência no caso #" << c << " (semente " << semente << ")\n";
+                imprimir_caso(minimizar(caso));
+            }
+        }
+        return divergencias;
+    }
+};
+
+// Retorna o número de divergências encontradas
+uint64_t rodar_fuzz(uint64_t casos, uint64_t semente) {
+    cout << "\n================ FUZZING EM LOCKSTEP ================\n";
+    cout << "Casos: " << casos << "  Semente: " << semente << "\n";
+    cout << "Passos por caso: " << FuzzerLockstep::MAX_PASSOS
+         << " (comparação a cada " << FuzzerLockstep::PASSOS_POR_BLOCO << ")\n";
+
+    FuzzerLockstep fuzzer;
+    clock_t inicio = clock();
+    uint64_t divergencias = fuzzer.rodar(casos, semente);
+    double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+
+    cout << "\nDivergências: " << divergencias << "\n";
+    if (segundos > 0)
+        cout << "Vazão: " << (uint64_t)(casos / segundos) << " casos/s\n";
+    cout << "=====================================================\n\n";
+    return divergencias;
+}
+
 bool test_memoria_basica(Barramento& bus) {
     cout << "\n[Teste] Memória básica (escrita/leitura 32-bit)\n";
     uint32_t addr = 0x00010;
@@ -513,12 +1246,112 @@ bool test_cpu_load_store(Barramento& bus, CPU& cpu) {
     return ok;
 }
 
+bool test_paginas_sujas() {
+    cout << "\n[Teste] Reset de memória por páginas sujas (fuzzer)\n";
+    FuzzerLockstep fuzzer;
+    GeradorAleatorio g(42);
+    for (int c = 0; c < 200; c++) fuzzer.executar_caso(fuzzer.gerar_caso(g));
+    bool ok = fuzzer.memorias_zeradas();
+    if (ok) cout << "PASS: páginas escritas pelos casos foram zeradas\n";
+    else    cout << "FAIL: reset por páginas sujas deixou dados na memória\n";
+    return ok;
+}
+
+bool test_fuzz_lockstep() {
+    cout << "\n[Teste] Fuzzing em lockstep (MotorRapido x CPU::executar)\n";
+    const uint64_t CASOS = 2000;
+    FuzzerLockstep fuzzer;
+    uint64_t divergencias = fuzzer.rodar(CASOS, 0xC0FFEE);
+    if (divergencias == 0) {
+        cout << "PASS: " << CASOS << " casos sem divergência\n";
+        return true;
+    }
+    cout << "FAIL: " << divergencias << " de " << CASOS << " casos divergiram\n";
+    return false;
+}
+
+bool test_uart(Barramento& bus) {
+    cout << "\n[Teste] UART na janela de E/S (TX/RX assíncronos)\n";
+    FILE* saida = tmpfile();
+    FILE* entrada = tmpfile();
+    if (!saida || !entrada) {
+        cout << "FAIL: não foi possível criar arquivos temporários\n";
+        return false;
+    }
+    const string rx_esperado = "RX-OK";
+    fputs(rx_esperado.c_str(), entrada);
+    rewind(entrada);
+
+    Uart uart(saida, fileno(entrada));
+    uart.iniciar();
+    bus.conectar_uart(&uart);
+
+    const string tx = "UART-TX\n";
+    for (char c : tx) {
+        while (!(bus.ler(Uart::REG_STATUS) & Uart::TX_LIVRE)) {}
+        bus.escrever(Uart::REG_TX, (uint8_t)c);
+    }
+
+    string rx;
+    for (;;) {
+        uint32_t status = bus.ler(Uart::REG_STATUS);
+        if (status & Uart::RX_DISPONIVEL) rx += (char)bus.ler(Uart::REG_RX);
+        else if (status & Uart::RX_FIM) break;
+    }
+
+    bus.conectar_uart(nullptr);
+    uart.encerrar();
+
+    rewind(saida);
+    string tx_lido;
+    int c;
+    while ((c = fgetc(saida)) != EOF) tx_lido += (char)c;
+    fclose(saida);
+    fclose(entrada);
+
+    bool ok = (tx_lido == tx) && (rx == rx_esperado);
+    if (ok) cout << "PASS: TX e RX da UART corretos (" << tx.size() << " bytes enviados, "
+                 << rx.size() << " recebidos)\n";
+    else    cout << "FAIL: TX lido '" << tx_lido << "' RX lido '" << rx << "'\n";
+    return ok;
+}
+
+bool test_uart_encerrar_pipe_ocioso() {
+    cout << "\n[Teste] UART encerra com a thread de RX esperando um pipe ocioso\n";
+    int fds[2];
+    if (!criar_pipe_host(fds)) {
+        cout << "FAIL: não foi possível criar o pipe\n";
+        return false;
+    }
+    // O escritor permanece aberto e nunca envia dados
+    Uart uart(stderr, fds[0]);
+    uart.iniciar();
+    this_thread::sleep_for(chrono::milliseconds(20));
+
+    auto inicio = chrono::steady_clock::now();
+    uart.encerrar();
+    auto ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - inicio).count();
+
+    // Após o join ninguém mais lê o descritor: fechar é seguro
+    fechar_entrada_host(fds[0]);
+    fechar_entrada_host(fds[1]);
+
+    bool ok = ms < 1000;
+    if (ok) cout << "PASS: encerrar() retornou em " << ms << " ms\n";
+    else    cout << "FAIL: encerrar() levou " << ms << " ms\n";
+    return ok;
+}
+
 void rodar_testes(Barramento& bus, DispositivoES& dev, CPU& cpu) {
     cout << "\n================ INICIANDO TESTES AUTOMATIZADOS ================\n";
     int total = 0, passed = 0;
     total++; if (test_memoria_basica(bus)) passed++;
     total++; if (test_vram_e_exibicao(bus, dev)) passed++;
     total++; if (test_cpu_load_store(bus, cpu)) passed++;
+    total++; if (test_paginas_sujas()) passed++;
+    total++; if (test_fuzz_lockstep()) passed++;
+    total++; if (test_uart(bus)) passed++;
+    total++; if (test_uart_encerrar_pipe_ocioso()) passed++;
 
     cout << "\n================ RESULTADO DOS TESTES ================\n";
     cout << "Total: " << total << "  Passaram: " << passed << "  Falharam: " << (total - passed) << "\n";
@@ -584,11 +1417,82 @@ void carregar_programa_completo(Barramento& barramento) {
 // =======================================================
 // MAIN
 // =======================================================
-int main(){
+static bool ler_numero(const char* texto, uint64_t& valor) {
+    if (!isdigit((unsigned char)texto[0])) return false;
+    char* fim = nullptr;
+    errno = 0;
+    valor = strtoull(texto, &fim, 0);
+    return errno == 0 && *fim == '\0';
+}
+
+static void mostrar_uso(const char* programa) {
+    cout << "Uso: " << programa << "\n";
+    cout << "     " << programa << " [--uart-saida <arquivo>] [--uart-entrada <arquivo|->]\n";
+    cout << "     " << programa << " --fuzz [casos] [semente]\n";
+    cout << "Sem --uart-saida, a saída da UART vai para stderr, separada do trace em stdout.\n";
+}
+
+int main(int argc, char** argv){
+    // Modo fuzzing: riscv_emulator --fuzz [casos] [semente]
+    if (argc > 1 && string(argv[1]) == "--fuzz") {
+        uint64_t casos = 1000000;
+        uint64_t semente = 1;
+        if (argc > 4 || (argc > 2 && !ler_numero(argv[2], casos))
+                     || (argc > 3 && !ler_numero(argv[3], semente))) {
+            mostrar_uso(argv[0]);
+            return 2;
+        }
+        return (rodar_fuzz(casos, semente) > 0) ? 1 : 0;
+    }
+
+    // Saída/entrada da UART: --uart-saida <arquivo> --uart-entrada <arquivo|->
+    // A saída padrão é stderr para não intercalar o console do guest com o trace
+    FILE* uart_saida = stderr;
+    int uart_entrada = -1;
+    auto fechar_uart = [&]() {
+        if (uart_saida != stderr) fclose(uart_saida);
+        fechar_entrada_host(uart_entrada);
+        uart_saida = stderr;
+        uart_entrada = -1;
+    };
+    for (int i = 1; i < argc; i += 2) {
+        string opcao = argv[i];
+        if (opcao != "--uart-saida" && opcao != "--uart-entrada") {
+            cout << "Opção desconhecida: " << opcao << "\n";
+            mostrar_uso(argv[0]);
+            fechar_uart();
+            return 2;
+        }
+        if (i + 1 >= argc) {
+            cout << "Opção sem argumento: " << opcao << "\n";
+            mostrar_uso(argv[0]);
+            fechar_uart();
+            return 2;
+        }
+        string arquivo = argv[i + 1];
+        bool aberto;
+        if (opcao == "--uart-saida") {
+            if (uart_saida != stderr) fclose(uart_saida);
+            uart_saida = fopen(arquivo.c_str(), "wb");
+            aberto = (uart_saida != nullptr);
+            if (!aberto) uart_saida = stderr;
+        } else {
+            fechar_entrada_host(uart_entrada);
+            uart_entrada = abrir_entrada_host(arquivo);
+            aberto = (uart_entrada >= 0);
+        }
+        if (!aberto) {
+            cout << "Não foi possível abrir " << arquivo << "\n";
+            fechar_uart();
+            return 1;
+        }
+    }
+
     Memoria memoria;
     Barramento barramento(&memoria);
     CPU cpu(&barramento);
     DispositivoES dispositivo_es(&memoria);
+    Uart uart(uart_saida, uart_entrada);
     
     const int INSTRUCOES_POR_ES = 10;  // Exibir VRAM a cada 10 instruções
     const int MAX_INSTRUCOES = 200;     // Limite de segurança
@@ -618,6 +1522,9 @@ int main(){
     // Rodar testes automáticos antes da execução principal
     rodar_testes(barramento, dispositivo_es, cpu);
 
+    uart.iniciar();
+    barramento.conectar_uart(&uart);
+
     cout << "=============== INICIANDO EXECUÇÃO ===============\n";
     cout << "Configuração de E/S: Exibir VRAM a cada " 
          << INSTRUCOES_POR_ES << " instruções\n";
@@ -651,6 +1558,8 @@ int main(){
         }
     }
 
+    uart.encerrar();
+
     // Exibição final
     cout << "\n\n";
     cout << "_____________________________________________________________\n";
@@ -689,7 +1598,11 @@ int main(){
     cout << "Operações de memória realizadas via barramento\n";
     cout << "VRAM utilizada para saída de caracteres ASCII\n";
     cout << "E/S programada com polling a cada " << INSTRUCOES_POR_ES << " instruções\n";
+    cout << "UART: " << uart.get_bytes_tx() << " bytes transmitidos, "
+         << uart.get_bytes_descartados() << " descartados (fila cheia)\n";
     cout << "=========================================================\n";
 
+    fechar_uart();
+
     return 0;
 }